@@ -0,0 +1,113 @@
+#include "muestreo_adaptativo.h"
+#include <math.h>
+
+// Peso de la muestra nueva en los promedios exponenciales
+static const float ALFA_PENDIENTE = 0.5f;
+static const float ALFA_RUIDO = 0.25f;
+// Un residuo menor a K_RUIDO veces el ruido estimado se considera ruido
+static const float K_RUIDO = 3.0f;
+
+AdaptiveSampler::AdaptiveSampler(uint32_t intervaloMinMs, uint32_t intervaloMaxMs,
+                                 uint32_t intervaloInicialMs, int umbralCambio)
+    : _intervaloMin(intervaloMinMs),
+      _intervaloMax(intervaloMaxMs < intervaloMinMs ? intervaloMinMs : intervaloMaxMs),
+      _intervaloInicial(intervaloInicialMs),
+      _umbral(umbralCambio > 0 ? umbralCambio : 1) {
+    if (_intervaloInicial < _intervaloMin) _intervaloInicial = _intervaloMin;
+    if (_intervaloInicial > _intervaloMax) _intervaloInicial = _intervaloMax;
+    reset();
+}
+
+void AdaptiveSampler::reset() {
+    _intervalo = _intervaloInicial;
+    _muestras = 0;
+    _primerMs = 0;
+    _ultimoMs = 0;
+    _ultimoValor = 0;
+    _pendiente = 0.0f;
+    _pendienteUltima = 0.0f;
+    _ruido = 0.0f;
+    _residuoPendiente = 0.0f;
+    _valorAntesSalto = 0;
+    _msAntesSalto = 0;
+    _hayPendiente = false;
+    _estable = false;
+}
+
+uint32_t AdaptiveSampler::update(int valor, uint32_t ahoraMs) {
+    // Tras una pausa larga la pendiente anterior ya no predice nada
+    if (_muestras > 0 && ahoraMs - _ultimoMs > 2 * _intervaloMax) {
+        reset();
+    }
+
+    if (_muestras == 0) {
+        _primerMs = ahoraMs;
+        _ultimoMs = ahoraMs;
+        _ultimoValor = valor;
+        _muestras = 1;
+        return _intervalo;
+    }
+
+    uint32_t dt = ahoraMs - _ultimoMs;
+    if (dt == 0) dt = 1;
+    float dtS = (float)dt / 1000.0f;
+
+    // Residuo respecto a extrapolar el ultimo paso: es ~0 en una rampa
+    // constante y solo crece con el ruido o con un cambio de pendiente
+    float cambio = (float)(valor - _ultimoValor);
+    float residuo = cambio - _pendienteUltima * dtS;
+
+    float umbral = (float)_umbral;
+    if (K_RUIDO * _ruido > umbral) umbral = K_RUIDO * _ruido;
+    bool transitorio = fabsf(residuo) > umbral;
+
+    if (_hayPendiente) {
+        // La muestra anterior dio un salto: si el valor vuelve al nivel previo
+        // era un pico de ruido; si no, era un cambio real y no se toma como ruido
+        _hayPendiente = false;
+        if (fabsf((float)(valor - _valorAntesSalto)) <= umbral) {
+            _ruido += ALFA_RUIDO * (fabsf(_residuoPendiente) - _ruido);
+            // El pico no cuenta para la pendiente
+            uint32_t dtPico = ahoraMs - _msAntesSalto;
+            if (dtPico == 0) dtPico = 1;
+            dtS = (float)dtPico / 1000.0f;
+            cambio = (float)(valor - _valorAntesSalto);
+            transitorio = false;
+        }
+    } else if (transitorio) {
+        _hayPendiente = true;
+        _residuoPendiente = residuo;
+        _valorAntesSalto = _ultimoValor;
+        _msAntesSalto = _ultimoMs;
+    } else {
+        _ruido += ALFA_RUIDO * (fabsf(residuo) - _ruido);
+    }
+
+    _pendienteUltima = cambio / dtS;
+    _pendiente += ALFA_PENDIENTE * (_pendienteUltima - _pendiente);
+
+    // Intervalo en el que la temperatura cambiaria ~umbral con la pendiente actual
+    float pendiente = fabsf(_pendiente);
+    float objetivo = (float)_intervaloMax;
+    if (pendiente * (float)_intervaloMax > umbral * 1000.0f) {
+        objetivo = umbral * 1000.0f / pendiente;
+    }
+
+    float siguiente = transitorio ? (float)_intervalo / 2.0f : (float)_intervalo * 2.0f;
+    if (siguiente > objetivo) siguiente = objetivo;
+    if (siguiente < (float)_intervaloMin) siguiente = (float)_intervaloMin;
+    if (siguiente > (float)_intervaloMax) siguiente = (float)_intervaloMax;
+    // Estable: sin transitorio y el intervalo puede alargarse
+    _estable = !transitorio && (uint32_t)siguiente > _intervalo;
+    _intervalo = (uint32_t)siguiente;
+
+    _ultimoMs = ahoraMs;
+    _ultimoValor = valor;
+    _muestras++;
+    return _intervalo;
+}
+
+float AdaptiveSampler::effectiveRate() const {
+    if (_muestras < 2 || _ultimoMs == _primerMs) return 0.0f;
+    return (float)(_muestras - 1) * 60000.0f / (float)(_ultimoMs - _primerMs);
+}
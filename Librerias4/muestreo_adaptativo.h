@@ -0,0 +1,56 @@
+#ifndef MUESTREO_ADAPTATIVO_H
+#define MUESTREO_ADAPTATIVO_H
+
+#include <stdint.h>
+
+// Planificador de muestreo adaptativo para un sensor.
+// Acorta el intervalo cuando la temperatura cambia rapido y lo duplica
+// (backoff exponencial) cuando la lectura es estable, siempre dentro de
+// [intervaloMin, intervaloMax]. No depende de mbed, para poder reproducir
+// trazas grabadas en el host (ver test/replay_muestreo.cpp).
+class AdaptiveSampler {
+public:
+    AdaptiveSampler(uint32_t intervaloMinMs, uint32_t intervaloMaxMs,
+                    uint32_t intervaloInicialMs, int umbralCambio);
+
+    // Registra una muestra (en centesimas de grado) tomada en ahoraMs y
+    // devuelve el intervalo en ms hasta la siguiente muestra.
+    uint32_t update(int valor, uint32_t ahoraMs);
+
+    uint32_t interval() const { return _intervalo; }
+    uint32_t samples() const { return _muestras; }
+    float slope() const { return _pendiente; }  // centesimas/s
+    float noise() const { return _ruido; }      // centesimas
+
+    // true si la ultima muestra no mostro transitorio y el intervalo se
+    // alargo: la lectura es estable y no hace falta seguir muestreando
+    bool steady() const { return _estable; }
+
+    // Tasa efectiva de muestreo en muestras por minuto desde el ultimo
+    // reset(). Una pausa mayor a 2 * intervaloMax tambien reinicia el estado.
+    float effectiveRate() const;
+
+    void reset();
+
+private:
+    uint32_t _intervaloMin;
+    uint32_t _intervaloMax;
+    uint32_t _intervaloInicial;
+    int _umbral;
+
+    uint32_t _intervalo;
+    uint32_t _muestras;
+    uint32_t _primerMs;
+    uint32_t _ultimoMs;
+    int _ultimoValor;
+    float _pendiente;        // promedio exponencial, centesimas/s
+    float _pendienteUltima;  // pendiente del ultimo paso, centesimas/s
+    float _ruido;
+    float _residuoPendiente; // residuo grande aun sin confirmar
+    int _valorAntesSalto;    // valor previo a ese residuo
+    uint32_t _msAntesSalto;
+    bool _hayPendiente;
+    bool _estable;
+};
+
+#endif
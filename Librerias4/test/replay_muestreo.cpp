@@ -0,0 +1,229 @@
+// Prueba en el host del muestreo adaptativo: reproduce trazas de temperatura
+// con muestreo fijo cada 2 s y con AdaptiveSampler, y compara conversiones y
+// error de seguimiento (muestra y retencion), tambien contra un muestreo fijo
+// con las mismas conversiones. Ver Makefile.
+#include "muestreo_adaptativo.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+// Mismos parametros que main.cpp
+const uint32_t INTERVALO_MIN_MS = 250;
+const uint32_t INTERVALO_MAX_MS = 16000;
+const uint32_t INTERVALO_INICIAL_MS = 2000;
+const int UMBRAL_CAMBIO = 10;
+const uint32_t INTERVALO_FIJO_MS = 2000;
+
+struct Punto {
+    uint32_t ms;
+    int valor;
+};
+
+struct Resultado {
+    int conversiones;
+    float errorMedio;
+};
+
+static int fallos = 0;
+
+static void verificar(bool condicion, const char* mensaje) {
+    printf("%s %s\n", condicion ? "[OK]   " : "[FALLO]", mensaje);
+    if (!condicion) fallos++;
+}
+
+static AdaptiveSampler nuevoMuestreo() {
+    return AdaptiveSampler(INTERVALO_MIN_MS, INTERVALO_MAX_MS, INTERVALO_INICIAL_MS, UMBRAL_CAMBIO);
+}
+
+static bool cargarTraza(const char* ruta, std::vector<Punto>& traza) {
+    FILE* f = fopen(ruta, "r");
+    if (!f) return false;
+    char linea[64];
+    while (fgets(linea, sizeof(linea), f)) {
+        Punto p;
+        unsigned long ms;
+        if (linea[0] == '#') continue;
+        if (sscanf(linea, "%lu,%d", &ms, &p.valor) == 2) {
+            p.ms = (uint32_t)ms;
+            traza.push_back(p);
+        }
+    }
+    fclose(f);
+    return !traza.empty();
+}
+
+// Con muestreo == NULL se muestrea cada intervaloFijo ms
+static Resultado reproducir(const std::vector<Punto>& traza, AdaptiveSampler* muestreo,
+                            uint32_t intervaloFijo) {
+    Resultado r = {0, 0.0f};
+    uint32_t siguiente = traza[0].ms;
+    int retenido = 0;
+    double errorTotal = 0;
+
+    for (const auto& p : traza) {
+        if (p.ms >= siguiente) {
+            retenido = p.valor;
+            r.conversiones++;
+            siguiente = p.ms + (muestreo ? muestreo->update(p.valor, p.ms) : intervaloFijo);
+        }
+        errorTotal += abs(p.valor - retenido);
+    }
+    r.errorMedio = (float)(errorTotal / (double)traza.size());
+    return r;
+}
+
+static void probarTraza(const char* ruta) {
+    std::vector<Punto> traza;
+    if (!cargarTraza(ruta, traza)) {
+        printf("[FALLO] no se pudo leer %s\n", ruta);
+        fallos++;
+        return;
+    }
+
+    AdaptiveSampler muestreo = nuevoMuestreo();
+    Resultado fijo = reproducir(traza, NULL, INTERVALO_FIJO_MS);
+    Resultado adaptativo = reproducir(traza, &muestreo, 0);
+
+    // Muestreo fijo con al menos tantas conversiones como el adaptativo
+    uint32_t duracion = traza.back().ms - traza.front().ms;
+    uint32_t intervaloIgual = duracion / (uint32_t)(adaptativo.conversiones - 1);
+    Resultado igual = reproducir(traza, NULL, intervaloIgual);
+    while (igual.conversiones < adaptativo.conversiones && intervaloIgual > 1) {
+        intervaloIgual--;
+        igual = reproducir(traza, NULL, intervaloIgual);
+    }
+
+    printf("%s\n", ruta);
+    printf("  fijo %5lu ms: %d conversiones, error medio %.2f centesimas\n",
+           (unsigned long)INTERVALO_FIJO_MS, fijo.conversiones, fijo.errorMedio);
+    printf("  fijo %5lu ms: %d conversiones, error medio %.2f centesimas\n",
+           (unsigned long)intervaloIgual, igual.conversiones, igual.errorMedio);
+    printf("  adaptativo:    %d conversiones, error medio %.2f centesimas\n",
+           adaptativo.conversiones, adaptativo.errorMedio);
+
+    verificar(adaptativo.conversiones < fijo.conversiones,
+              "menos conversiones que el muestreo fijo de 2 s");
+    verificar(igual.conversiones >= adaptativo.conversiones &&
+              adaptativo.errorMedio < igual.errorMedio,
+              "menor error que el muestreo fijo con las mismas conversiones");
+}
+
+// Una rampa de 40 centesimas por muestra no debe confundirse con ruido ni alargar el intervalo
+static void probarRampa() {
+    AdaptiveSampler muestreo = nuevoMuestreo();
+    uint32_t t = 0;
+    int valor = 2000;
+    bool nuncaCrece = true;
+    for (int i = 0; i < 6; i++) {
+        uint32_t intervalo = muestreo.update(valor, t);
+        if (intervalo > INTERVALO_INICIAL_MS) nuncaCrece = false;
+        t += intervalo;
+        valor += 40;
+    }
+    verificar(nuncaCrece, "rampa: el intervalo nunca se alarga");
+    verificar(muestreo.interval() < INTERVALO_INICIAL_MS, "rampa: el intervalo se acorta");
+    verificar(muestreo.noise() < (float)UMBRAL_CAMBIO, "rampa: no se toma como ruido");
+}
+
+// Una pausa larga entre rafagas no debe inflar el ruido ni la tasa
+static void probarPausa() {
+    AdaptiveSampler muestreo = nuevoMuestreo();
+    uint32_t t = 0;
+    int valor = 2000;
+    for (int i = 0; i < 4; i++) {
+        t += muestreo.update(valor, t);
+        valor += 20 * (int)muestreo.interval() / 1000;  // 0.2 C/s
+    }
+
+    t += 10 * 60 * 1000;
+    for (int i = 0; i < 4; i++) {
+        muestreo.update(valor, t);
+        t += INTERVALO_INICIAL_MS;
+    }
+    verificar(muestreo.noise() < (float)UMBRAL_CAMBIO, "pausa: el ruido sigue acotado");
+    verificar(muestreo.effectiveRate() >= 29.0f, "pausa: la tasa cuenta solo la rafaga actual");
+
+    for (int i = 0; i < 3; i++) {
+        valor += 40;
+        muestreo.update(valor, t);
+        t += INTERVALO_INICIAL_MS;
+    }
+    verificar(muestreo.interval() < INTERVALO_INICIAL_MS, "pausa: detecta el transitorio siguiente");
+}
+
+// Un escalon que se mantiene es un cambio real, no debe subir el ruido
+static void probarEscalon() {
+    AdaptiveSampler muestreo = nuevoMuestreo();
+    uint32_t t = 0;
+    for (int i = 0; i < 8; i++) {
+        muestreo.update(i < 4 ? 2000 : 2100, t);
+        t += INTERVALO_INICIAL_MS;
+    }
+    verificar(3.0f * muestreo.noise() <= (float)UMBRAL_CAMBIO, "escalon: no se toma como ruido");
+
+    uint32_t antes = muestreo.interval();
+    muestreo.update(2130, t);
+    verificar(muestreo.interval() < antes, "escalon: detecta un cambio de 0.30 C despues");
+}
+
+// Un pico aislado que vuelve al nivel previo si es ruido, y cuenta una vez
+static void probarPico() {
+    AdaptiveSampler muestreo = nuevoMuestreo();
+    uint32_t t = 0;
+    for (int i = 0; i < 8; i++) {
+        muestreo.update(i == 4 ? 2100 : 2000, t);
+        t += INTERVALO_INICIAL_MS;
+    }
+    // Un solo paso del promedio exponencial (alfa 0.25) sobre un residuo de 100
+    verificar(muestreo.noise() > 0.0f && muestreo.noise() <= 25.0f,
+              "pico: se toma como ruido una sola vez");
+}
+
+// Misma logica de rafaga que main(): hasta maxMuestras conversiones, se
+// termina antes si la lectura es estable. Devuelve la espera total en ms.
+static uint32_t rafaga(AdaptiveSampler& muestreo, int (*valor)(uint32_t),
+                       int maxMuestras, int& conversiones) {
+    uint32_t t = 0;
+    muestreo.reset();
+    for (conversiones = 1; ; conversiones++) {
+        uint32_t intervalo = muestreo.update(valor(t), t);
+        if (conversiones == maxMuestras || muestreo.steady()) break;
+        t += intervalo;
+    }
+    return t;
+}
+
+static int valorEstable(uint32_t) { return 2250; }
+static int valorRampa(uint32_t ms) { return 2000 + (int)(ms / 50); }  // 0.2 C/s
+
+static void probarRafaga() {
+    AdaptiveSampler muestreo = nuevoMuestreo();
+    const int maxMuestras = 4;
+    const uint32_t esperaFija = (maxMuestras - 1) * INTERVALO_FIJO_MS;
+    int conversiones;
+
+    uint32_t espera = rafaga(muestreo, valorEstable, maxMuestras, conversiones);
+    verificar(conversiones < maxMuestras && espera < esperaFija,
+              "rafaga estable: menos conversiones y menos espera");
+
+    espera = rafaga(muestreo, valorRampa, maxMuestras, conversiones);
+    verificar(conversiones == maxMuestras && espera < esperaFija,
+              "rafaga en rampa: todas las conversiones, mas juntas");
+}
+
+int main(int argc, char** argv) {
+    probarRampa();
+    probarPausa();
+    probarEscalon();
+    probarPico();
+    probarRafaga();
+    if (argc < 2) {
+        probarTraza("trazas/calentamiento.csv");
+    }
+    for (int i = 1; i < argc; i++) {
+        probarTraza(argv[i]);
+    }
+
+    printf("%s\n", fallos ? "FALLO" : "OK");
+    return fallos ? 1 : 0;
+}
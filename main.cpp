@@ -2,6 +2,7 @@
 #include "ssd1306.h"
 #include "tm1638.h"
 #include "si7021.h"
+#include "muestreo_adaptativo.h"
 #include <vector>
 #include <algorithm>
 
@@ -16,13 +17,19 @@
 
 // Constantes del sistema
 const int NUM_MUESTRAS = 10;
-const int LM35_MUESTRAS = 4;
-const int SI7021_MUESTRAS = 4;
+const int LM35_MUESTRAS = 4;         // Máximo por ráfaga (muestreo adaptativo)
+const int SI7021_MUESTRAS = 4;       // Máximo por ráfaga (muestreo adaptativo)
 const int RESISTIVE_MUESTRAS = 2;
 const int TEMP_REFERENCIA = 2000;  // 20.00°C
 const int CALIBRACION = 100;       // Factor de calibración (1.00)
 const int UMBRAL_RUIDO = 10;       // Umbral para ruido (0.10V * 100)
 
+// Constantes del muestreo adaptativo
+const uint32_t INTERVALO_MIN_MS = 250;
+const uint32_t INTERVALO_MAX_MS = 16000;
+const uint32_t INTERVALO_INICIAL_MS = 2000;
+const int UMBRAL_CAMBIO = 10;      // Cambio significativo (0.10°C)
+
 // Constantes para el termistor NTC
 const float R_REFERENCIA = 10000.0;  // 10k ohm
 const float BETA = 3950.0;           // Valor típico para NTC
@@ -36,12 +43,17 @@ Si7021 si7021(SI7021_SDA_PIN, SI7021_SCL_PIN);
 SSD1306 oled(i2c);
 TM1638 display(TM1638_DIO_PIN, TM1638_CLK_PIN, TM1638_STB_PIN);
 
+// Un planificador por sensor; se reinicia al comenzar cada rafaga de medicion.
+// El resistivo toma solo 2 muestras, muy pocas para adaptar: va a intervalo fijo.
+AdaptiveSampler muestreoLM35(INTERVALO_MIN_MS, INTERVALO_MAX_MS, INTERVALO_INICIAL_MS, UMBRAL_CAMBIO);
+AdaptiveSampler muestreoSI7021(INTERVALO_MIN_MS, INTERVALO_MAX_MS, INTERVALO_INICIAL_MS, UMBRAL_CAMBIO);
+
 struct Temperatura {
     int entero;
     int decimal;
 };
 
-std::vector<Temperatura> medidas(NUM_MUESTRAS);
+std::vector<Temperatura> medidas;
 Temperatura promedio, mediana;
 int errorAbsoluto, errorRelativo;
 bool medicionCompleta = false;
@@ -175,6 +187,36 @@ Temperatura convertirPorcentajeADisplay(int valor) {
     return t;
 }
 
+uint32_t tiempoMs() {
+    return (uint32_t)(Kernel::Clock::now().time_since_epoch().count());
+}
+
+// Toma hasta maxMuestras lecturas separadas por el intervalo del planificador.
+// Si la lectura es estable la rafaga termina antes: menos conversiones y menos
+// espera; en un transitorio las muestras se toman mas juntas.
+void medirAdaptativo(Temperatura (*leer)(), const char* etiqueta,
+                     AdaptiveSampler& muestreo, int maxMuestras) {
+    muestreo.reset();
+    for (int i = 0; i < maxMuestras; i++) {
+        Temperatura t = leer();
+        medidas.push_back(t);
+        mostrarValorTM1638(t);
+        mostrarEnOLED(etiqueta, t, "C", 2);
+
+        uint32_t intervalo = muestreo.update(t.entero * 100 + t.decimal, tiempoMs());
+        if (i == maxMuestras - 1 || muestreo.steady()) {
+            break;
+        }
+        ThisThread::sleep_for(std::chrono::milliseconds(intervalo));
+    }
+}
+
+// Tasa efectiva de la rafaga, con los tiempos realmente aplicados
+void reportarTasa(const char* nombre, const AdaptiveSampler& muestreo) {
+    printf("%s: %lu conversiones, %.2f muestras/min\n",
+           nombre, (unsigned long)muestreo.samples(), muestreo.effectiveRate());
+}
+
 void manejarBotones() {
     uint8_t botones = display.readButtons();
 
@@ -216,37 +258,31 @@ int main() {
     
     display.init();
     display.setBrightness(7);
+    medidas.reserve(NUM_MUESTRAS);
 
     while (true) {
         if (!medicionCompleta) {
-            int idx = 0;
+            medidas.clear();
             
             oled.clearDisplay();
             oled.displayText("Midiendo LM35...", 0);
-            for (int i = 0; i < LM35_MUESTRAS; i++, idx++) {
-                medidas[idx] = leerTemperaturaLM35();
-                mostrarValorTM1638(medidas[idx]);
-                mostrarEnOLED("LM35: ", medidas[idx], "C", 2);
-                ThisThread::sleep_for(2s);
-            }
+            medirAdaptativo(leerTemperaturaLM35, "LM35: ", muestreoLM35, LM35_MUESTRAS);
+            reportarTasa("LM35", muestreoLM35);
             
             oled.clearDisplay();
             oled.displayText("Midiendo SI7021...", 0);
-            for (int i = 0; i < SI7021_MUESTRAS; i++, idx++) {
-                medidas[idx] = leerTemperaturaSI7021();
-                mostrarValorTM1638(medidas[idx]);
-                mostrarEnOLED("SI7021: ", medidas[idx], "C", 2);
-                ThisThread::sleep_for(2s);
-            }
+            medirAdaptativo(leerTemperaturaSI7021, "SI7021: ", muestreoSI7021, SI7021_MUESTRAS);
+            reportarTasa("SI7021", muestreoSI7021);
             
             oled.clearDisplay();
             oled.displayText("Midiendo Resistivo...", 0);
-            for (int i = 0; i < RESISTIVE_MUESTRAS; i++, idx++) {
-                medidas[idx] = leerTemperaturaResistiva();
-                mostrarValorTM1638(medidas[idx]);
-                mostrarEnOLED("Resistivo: ", medidas[idx], "C", 2);
+            for (int i = 0; i < RESISTIVE_MUESTRAS; i++) {
+                medidas.push_back(leerTemperaturaResistiva());
+                mostrarValorTM1638(medidas.back());
+                mostrarEnOLED("Resistivo: ", medidas.back(), "C", 2);
                 ThisThread::sleep_for(2s);
             }
+            printf("Resistivo: %d conversiones, intervalo fijo 2000 ms\n", RESISTIVE_MUESTRAS);
 
             promedio = calcularPromedio(medidas);
             mediana = calcularMediana(medidas);